@@ -0,0 +1,660 @@
+#ifndef BOT_FRAMEWORK_H
+#define BOT_FRAMEWORK_H
+
+// Building blocks shared by all the search bots. A bot is a search strategy
+// instantiated with a parameter struct and a rollout policy, e.g.
+//   TreeSearch<TreeParams<>, EvasiveRollout>
+// so that every configuration gets its own fully specialised code. A search
+// strategy provides
+//   static std::string Name();                  // describe the configuration
+//   static void NewGame();                      // reset per-game state
+//   static Command Decide(const World& world);  // choose this turn's action
+// and for pondering (searching on the expected next world while waiting for
+// the referee)
+//   // Works on the world in a background thread until stop is set.
+//   static void Ponder(const World& world, const std::atomic<bool>& stop);
+//   // Whether Ponder is left to finish, rather than stopped, when the input
+//   // matches the world it was called with.
+//   static constexpr bool kFinishPonderingOnMatch;
+//   // Same as Decide, called only with the world Ponder was called with.
+//   // start is when the input arrived, before the ponder thread was joined.
+//   static Command Resume(const World& world,
+//                         std::chrono::high_resolution_clock::time_point start);
+
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <chrono>
+#include <cstdlib>
+
+#include "world.hpp"
+
+struct Command {
+  enum Type {MOVE, SHOOT};
+  static Command Move(const Vector2D& target) {
+    Command command;
+    command.type = MOVE;
+    command.target = target;
+    return command;
+  }
+  static Command Shoot(int target_id) {
+    Command command;
+    command.type = SHOOT;
+    command.target_id = target_id;
+    return command;
+  }
+  // Gives the command to Wolff, World::step has to be called to execute it.
+  void Apply(World& world) const {
+    if (type == MOVE) {
+      world.wolff.move(target);
+    } else {
+      world.wolff.shoot(target_id);
+    }
+  }
+  Type type = SHOOT;
+  Vector2D target;
+  int target_id = -1;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const Command& command) {
+  if (command.type == Command::MOVE) {
+    return out << "MOVE " << command.target.x << " " << command.target.y;
+  }
+  return out << "SHOOT " << command.target_id;
+}
+
+// Returns the position of the enemy which will be the closest one to Wolff
+// after enemies make their next move.
+inline Vector2D GetDangerousEnemyPos(const World& world) {
+  Vector2D pos = world.enemies.front().pos;
+  for (auto enemy : world.enemies) {
+    enemy.move(world);
+    if (world.wolff.pos.dist2(enemy.pos) < world.wolff.pos.dist2(pos)) {
+      pos = enemy.pos;
+    }
+  }
+  return pos;
+}
+
+// Rollout policies play the game till the end from the given world and
+// return the final score. Choose returns the action the policy takes in the
+// given world.
+
+// Runs away from the most dangerous enemy if it is about to get Wolff,
+// otherwise shoots the nearest enemy.
+struct EvasiveRollout {
+  static Command Choose(const World& world) {
+    Vector2D pos = GetDangerousEnemyPos(world);
+    if (world.wolff.pos.dist2(pos) <= kEnemyRange * kEnemyRange) {
+      const auto& wolff = world.wolff;
+      Vector2D target(wolff.pos.x + (wolff.pos.x - pos.x), wolff.pos.y + (wolff.pos.y - pos.y));
+      if (target.IsInsideArena()) {
+        return Command::Move(target);
+      }
+    }
+    return Command::Shoot(world.FindNearestEnemy(world.wolff.pos));
+  }
+  static int Run(World& world) {
+    while (!world.IsGameOver()) {
+      Choose(world).Apply(world);
+      world.step();
+    }
+    return world.score;
+  }
+};
+
+// Returns the offsets of kStepsNum headings evenly spread around the circle.
+template <int kStepsNum, int kDistance>
+const std::array<std::pair<double, double>, kStepsNum>& GetHeadings() {
+  static const auto headings = [] {
+    std::array<std::pair<double, double>, kStepsNum> res;
+    for (int i = 0; i < kStepsNum; ++i) {
+      double angle = i * 2.0 * M_PI / kStepsNum;
+      res[i] = {kDistance * cos(angle), kDistance * sin(angle)};
+    }
+    return res;
+  }();
+  return headings;
+}
+
+template <int kAngleStepsNum_ = 8, int kSearchDepth_ = 2,
+          int kMaxEnemiesForLookahead_ = 20, int kMaxEnemiesForTargets_ = 20,
+          int kRefineRounds_ = 0, int kRefineCandidates_ = 2,
+          bool kClampToArena_ = false>
+struct TreeParams {
+  // Number of MOVE headings tried on every level of the tree.
+  static constexpr int kAngleStepsNum = kAngleStepsNum_;
+  static constexpr int kMoveDistance = 1000;
+  // Number of consecutive MOVEs searched before the rollout takes over.
+  static constexpr int kSearchDepth = kSearchDepth_;
+  // Deeper levels are only searched if there are fewer enemies than this.
+  static constexpr int kMaxEnemiesForLookahead = kMaxEnemiesForLookahead_;
+  // Shooting every enemy first is only tried if there are at most this many
+  // enemies, otherwise the nearest one is shot.
+  static constexpr int kMaxEnemiesForTargets = kMaxEnemiesForTargets_;
+  // Rounds of local search around the best first MOVEs. Every round tries
+  // turning the kRefineCandidates best ones by half of the previous angle
+  // step either way and halving their length.
+  static constexpr int kRefineRounds = kRefineRounds_;
+  static constexpr int kRefineCandidates = kRefineCandidates_;
+  // Whether MOVEs leaving the arena are clamped to it rather than skipped.
+  static constexpr bool kClampToArena = kClampToArena_;
+};
+
+// Tries a few consecutive MOVEs in every direction followed by a rollout, and
+// shooting each enemy until it dies followed by a rollout.
+template <class Params, class Rollout>
+struct TreeSearch {
+  static std::string Name() {
+    return "tree angles=" + std::to_string(Params::kAngleStepsNum)
+        + " depth=" + std::to_string(Params::kSearchDepth)
+        + " lookahead<" + std::to_string(Params::kMaxEnemiesForLookahead)
+        + " targets<=" + std::to_string(Params::kMaxEnemiesForTargets)
+        + (Params::kRefineRounds > 0
+           ? " refine=" + std::to_string(Params::kRefineRounds)
+             + "x" + std::to_string(Params::kRefineCandidates)
+           : "")
+        + (Params::kClampToArena ? " clamp" : "");
+  }
+
+  static void NewGame() {}
+
+  // Scores of the positions Wolff can end up in after a MOVE. Many targets
+  // lead to the same position since Vector2D::move truncates, and the outcome
+  // only depends on the position.
+  using MoveScores = std::vector<std::pair<int, int>>;
+
+  struct MoveCandidate {
+    double angle;
+    double length;
+    int score;
+  };
+
+  static bool IsStopped(const std::atomic<bool>* stop) {
+    return stop != nullptr && *stop;
+  }
+
+  template <int kDepth>
+  static int GetMoveScore(const World& world, const Vector2D& target, MoveScores& scores,
+                          const std::atomic<bool>* stop) {
+    Vector2D next_pos = world.wolff.pos;
+    next_pos.move(target);
+    int key = next_pos.x * kHeight + next_pos.y;
+    for (const auto& entry : scores) {
+      if (entry.first == key) {
+        return entry.second;
+      }
+    }
+    World test_world = world;
+    test_world.wolff.move(target);
+    test_world.step();
+    int cur_score;
+    if constexpr (kDepth + 1 < Params::kSearchDepth) {
+      World test_world2 = test_world;
+      cur_score = Rollout::Run(test_world);
+      if (world.enemies.size() < Params::kMaxEnemiesForLookahead) {
+        Vector2D tmp;
+        cur_score = std::max(GetBestMove<kDepth + 1>(test_world2, tmp, stop), cur_score);
+      }
+    } else {
+      cur_score = Rollout::Run(test_world);
+    }
+    scores.emplace_back(key, cur_score);
+    return cur_score;
+  }
+
+  // Returns false if the target leaves the arena and can't be clamped.
+  static bool FixTarget(Vector2D& target) {
+    if (target.IsInsideArena()) {
+      return true;
+    }
+    if (Params::kClampToArena) {
+      target.ClampToArena();
+      return true;
+    }
+    return false;
+  }
+
+  // The search returns early with whatever it has found if stop is set.
+  template <int kDepth = 0>
+  static int GetBestMove(const World& world, Vector2D& pos,
+                         const std::atomic<bool>* stop = nullptr) {
+    if (world.IsGameOver()) {
+      return world.score;
+    }
+    const auto& headings = GetHeadings<Params::kAngleStepsNum, Params::kMoveDistance>();
+    MoveScores scores;
+    std::vector<MoveCandidate> candidates;
+    int max_score = INT_MIN;
+    for (int i = 0; i < Params::kAngleStepsNum; ++i) {
+      if (IsStopped(stop)) {
+        return max_score;
+      }
+      Vector2D next_pos = world.wolff.pos;
+      next_pos.x += headings[i].first;
+      next_pos.y += headings[i].second;
+      if (!FixTarget(next_pos)) {
+        continue;
+      }
+      int cur_score = GetMoveScore<kDepth>(world, next_pos, scores, stop);
+      candidates.push_back({i * 2.0 * M_PI / Params::kAngleStepsNum,
+                            static_cast<double>(Params::kMoveDistance), cur_score});
+      if (cur_score > max_score) {
+        max_score = cur_score;
+        pos = next_pos;
+      }
+    }
+    if constexpr (kDepth == 0 && Params::kRefineRounds > 0) {
+      double delta = M_PI / Params::kAngleStepsNum;
+      for (int round = 0; round < Params::kRefineRounds; ++round, delta /= 2) {
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const MoveCandidate& a, const MoveCandidate& b) {
+                           return a.score > b.score;
+                         });
+        if (candidates.size() > Params::kRefineCandidates) {
+          candidates.resize(Params::kRefineCandidates);
+        }
+        for (int i = 0, n = candidates.size(); i < n; ++i) {
+          const MoveCandidate parent = candidates[i];
+          const MoveCandidate children[] = {
+            {parent.angle - delta, parent.length, 0},
+            {parent.angle + delta, parent.length, 0},
+            {parent.angle, parent.length / 2, 0},
+          };
+          for (auto child : children) {
+            if (IsStopped(stop)) {
+              return max_score;
+            }
+            Vector2D next_pos = world.wolff.pos;
+            next_pos.x += child.length * cos(child.angle);
+            next_pos.y += child.length * sin(child.angle);
+            if (!FixTarget(next_pos)) {
+              continue;
+            }
+            child.score = GetMoveScore<kDepth>(world, next_pos, scores, stop);
+            candidates.push_back(child);
+            if (child.score > max_score) {
+              max_score = child.score;
+              pos = next_pos;
+            }
+          }
+        }
+      }
+    }
+    return max_score;
+  }
+
+  static int GetBestShoot(const World& world, int& id,
+                          const std::atomic<bool>* stop = nullptr) {
+    World test_world = world;
+    id = world.FindNearestEnemy(world.wolff.pos);
+    int max_score = Rollout::Run(test_world);
+    if (world.enemies.size() > Params::kMaxEnemiesForTargets) return max_score;
+    for (const auto& enemy : world.enemies) {
+      if (IsStopped(stop)) {
+        return max_score;
+      }
+      World test_world = world;
+      while (!test_world.IsGameOver() && test_world.IsEnemyAlive(enemy.id)) {
+        test_world.wolff.shoot(enemy.id);
+        test_world.step();
+      }
+      int cur_score = Rollout::Run(test_world);
+      if (cur_score > max_score) {
+        max_score = cur_score;
+        id = enemy.id;
+      }
+    }
+    return max_score;
+  }
+
+  static Command Decide(const World& world, const std::atomic<bool>* stop = nullptr) {
+    Vector2D best_move;
+    int move_score = GetBestMove(world, best_move, stop);
+    int best_target = -1;
+    int shoot_score = GetBestShoot(world, best_target, stop);
+    if (move_score > shoot_score) {
+      return Command::Move(best_move);
+    }
+    Command command = Rollout::Choose(world);
+    if (command.type == Command::MOVE) {
+      return command;
+    }
+    return Command::Shoot(best_target);
+  }
+
+  // The search is deterministic and takes a few milliseconds at most, so the
+  // whole decision is made in the background. It is dropped if stop comes
+  // first, and Resume then decides from scratch. On a match it is the same
+  // work Decide would do, so it is left to finish.
+  static constexpr bool kFinishPonderingOnMatch = true;
+
+  static void Ponder(const World& world, const std::atomic<bool>& stop) {
+    has_pondered_ = false;
+    pondered_command_ = Decide(world, &stop);
+    has_pondered_ = !stop;
+  }
+
+  static Command Resume(const World& world, std::chrono::high_resolution_clock::time_point) {
+    if (!has_pondered_) {
+      return Decide(world);
+    }
+    has_pondered_ = false;
+    return pondered_command_;
+  }
+
+  inline static Command pondered_command_;
+  inline static bool has_pondered_ = false;
+};
+
+template <int kPopulationSize_ = 100, int kMovesNum_ = 4,
+          int kTimeLimitMs_ = 80, int kMutationPercent_ = 100,
+          int kRecombinationsPercent_ = 100, int kGenomeSize_ = 1,
+          int kMaxGenerations_ = 1000>
+struct GeneticParams {
+  static constexpr int kGenomeSize = kGenomeSize_;
+  // Number of MOVE headings a gene can encode.
+  static constexpr int kMovesNum = kMovesNum_;
+  static constexpr int kMoveDistance = 1000;
+  static constexpr int kPopulationSize = kPopulationSize_;
+  // Number of mutants and children added every generation, in percent of the
+  // population size.
+  static constexpr int kMutationPercent = kMutationPercent_;
+  static constexpr int kRecombinationsPercent = kRecombinationsPercent_;
+  // A turn ends after kTimeLimitMs or kMaxGenerations generations, whichever
+  // comes first. Capping only the generations makes the search reproducible.
+  static constexpr int kTimeLimitMs = kTimeLimitMs_;
+  static constexpr int kMaxGenerations = kMaxGenerations_;
+  static constexpr unsigned kSeed = 42;
+};
+
+// Evolves short sequences of MOVEs, each of them followed by a rollout.
+template <class Params, class Rollout>
+struct GeneticSearch {
+  // Headings leaving the arena are clamped to it, as moving out loses.
+  static Vector2D ConvertMove(const Vector2D& pos, int move_id) {
+    const auto& heading = GetHeadings<Params::kMovesNum, Params::kMoveDistance>()[move_id];
+    Vector2D next_pos = pos;
+    next_pos.x += heading.first;
+    next_pos.y += heading.second;
+    next_pos.ClampToArena();
+    return next_pos;
+  }
+
+  // Either one of the MOVE headings or handing the game over to the rollout.
+  struct GameMove {
+    GameMove() : type(MOVE), move_id(0) {
+    }
+    void GenerateRandom() {
+      int id = rand() % (Params::kMovesNum + 1);
+      if (id < Params::kMovesNum) {
+        type = MOVE;
+        move_id = id;
+      } else {
+        type = ROLLOUT;
+      }
+    }
+    void Apply(World& world) const {
+      if (world.IsGameOver()) return;
+      if (type == MOVE) {
+        world.wolff.move(ConvertMove(world.wolff.pos, move_id));
+        world.step();
+      } else {
+        Rollout::Run(world);
+      }
+    }
+    enum Type {MOVE, ROLLOUT} type;
+    int move_id;
+  };
+
+  struct Genome {
+    Genome() : score(0) {
+    }
+    void GenerateRandom() {
+      for (auto& move : moves) {
+        move.GenerateRandom();
+      }
+    }
+    void Recombine(const Genome& g) {
+      int mid = Params::kGenomeSize > 2 ? (rand() % (Params::kGenomeSize - 2)) + 1 : 1;
+      for (int i = mid; i < Params::kGenomeSize; ++i) {
+        moves[i] = g.moves[i];
+      }
+    }
+    void Rescore(World world) {
+      for (const auto& move : moves) {
+        if (world.IsGameOver()) break;
+        move.Apply(world);
+      }
+      score = Rollout::Run(world);
+    }
+    void Mutate() {
+      moves[rand() % moves.size()].GenerateRandom();
+    }
+    int Score() const {
+      return score;
+    }
+    bool operator<(const Genome& g) const {
+      return score > g.score;
+    }
+    int score;
+    std::array<GameMove, Params::kGenomeSize> moves;
+  };
+
+  struct Population {
+    Population() {}
+    // Scoring stops early if stop is set, leaving the population incomplete.
+    Population(const World& world, const std::atomic<bool>* stop = nullptr) {
+      for (int i = 0; i < Params::kPopulationSize; ++i) {
+        auto genome = Genome();
+        genome.GenerateRandom();
+        genomes.push_back(std::move(genome));
+      }
+      for (int i = 0; i < Params::kPopulationSize; ++i) {
+        if (stop != nullptr && *stop) {
+          return;
+        }
+        genomes[i].Rescore(world);
+      }
+      is_complete = true;
+    }
+    // The unfinished generation is dropped if stop is set.
+    void GenerateNext(const World& world, const std::atomic<bool>* stop = nullptr) {
+      int n = genomes.size();
+      int mutants_num = n * Params::kMutationPercent / 100;
+      int recombinations_num = n * Params::kRecombinationsPercent / 100;
+      for (int i = 0; i < mutants_num; ++i) {
+        if (stop != nullptr && *stop) {
+          genomes.resize(n);
+          return;
+        }
+        Genome new_genome = genomes[rand() % n];
+        new_genome.Mutate();
+        new_genome.Rescore(world);
+        genomes.push_back(std::move(new_genome));
+      }
+      for (int i = 0; i < recombinations_num; ++i) {
+        if (stop != nullptr && *stop) {
+          genomes.resize(n);
+          return;
+        }
+        Genome new_genome = genomes[rand() % (n / 2)];
+        new_genome.Recombine(genomes[(rand() % (n / 2)) + n / 2]);
+        new_genome.Rescore(world);
+        genomes.push_back(std::move(new_genome));
+      }
+      std::sort(genomes.begin(), genomes.end());
+      genomes.resize(Params::kPopulationSize);
+    }
+    GameMove GetBestMove(int& score) const {
+      int max_score = INT_MIN;
+      GameMove best_move;
+      for (const auto& genome : genomes) {
+        if (genome.Score() > max_score) {
+          max_score = genome.Score();
+          best_move = genome.moves[0];
+        }
+      }
+      score = max_score;
+      return best_move;
+    }
+    std::vector<Genome> genomes;
+    bool is_complete = false;
+  };
+
+  static std::string Name() {
+    return "ga population=" + std::to_string(Params::kPopulationSize)
+        + " moves=" + std::to_string(Params::kMovesNum)
+        + " time=" + std::to_string(Params::kTimeLimitMs) + "ms"
+        + " mutation=" + std::to_string(Params::kMutationPercent) + "%"
+        + " recombination=" + std::to_string(Params::kRecombinationsPercent) + "%";
+  }
+
+  static void NewGame() {
+    srand(Params::kSeed);
+  }
+
+  static Command Decide(const World& world) {
+    auto start = std::chrono::high_resolution_clock::now();
+    Population population(world);
+    return Evolve(world, population, start);
+  }
+
+  // Keeps pondering generations until stop is set; Resume then carries on
+  // from them for the rest of the turn's time limit.
+  static constexpr bool kFinishPonderingOnMatch = false;
+
+  static void Ponder(const World& world, const std::atomic<bool>& stop) {
+    pondered_ = Population(world, &stop);
+    for (int pid = 0; pondered_.is_complete && !stop && pid < Params::kMaxGenerations; ++pid) {
+      pondered_.GenerateNext(world, &stop);
+    }
+  }
+
+  static Command Resume(const World& world, std::chrono::high_resolution_clock::time_point start) {
+    if (!pondered_.is_complete) {
+      Population population(world);
+      return Evolve(world, population, start);
+    }
+    pondered_.is_complete = false;
+    return Evolve(world, pondered_, start);
+  }
+
+  // Evolves the population until the time limit of the turn, counted from
+  // start, and picks the action.
+  static Command Evolve(const World& world, Population& population,
+                        std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    int pid = 0;
+    while (std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() < Params::kTimeLimitMs
+           && pid < Params::kMaxGenerations) {
+      population.GenerateNext(world);
+      end = std::chrono::high_resolution_clock::now();
+      ++pid;
+    }
+    int ga_score;
+    GameMove best_move = population.GetBestMove(ga_score);
+    World test_world = world;
+    int stand_score = Rollout::Run(test_world);
+    if (ga_score > stand_score && best_move.type == GameMove::MOVE) {
+      return Command::Move(ConvertMove(world.wolff.pos, best_move.move_id));
+    }
+    return Rollout::Choose(world);
+  }
+
+  inline static Population pondered_;
+};
+
+struct GameResult {
+  int score = 0;
+  int turns = 0;
+  double total_ms = 0;
+  double max_turn_ms = 0;
+};
+
+// Plays a whole game in-process with World::step as the referee. Every turn
+// the bot sees the world the way it would be read from the game input.
+template <class Search>
+GameResult PlayGame(World world) {
+  GameResult result;
+  Search::NewGame();
+  while (!world.IsGameOver()) {
+    World view = world;
+    view.Init();
+    auto start = std::chrono::high_resolution_clock::now();
+    Command command = Search::Decide(view);
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    result.total_ms += ms;
+    result.max_turn_ms = std::max(result.max_turn_ms, ms);
+    ++result.turns;
+    command.Apply(world);
+    world.step();
+  }
+  result.score = world.score;
+  return result;
+}
+
+// The game loop talking to the referee over stdin/stdout. With --ponder the
+// world expected after our action is searched in the background while waiting
+// for the next input; if the input matches, the decision builds on that work.
+template <class Search>
+int RunBot(int argc, char** argv) {
+  bool ponder = argc > 1 && std::string(argv[1]) == "--ponder";
+  Search::NewGame();
+  World world;
+  World predicted;
+  bool is_pondering = false;
+  std::atomic<bool> stop(false);
+  std::thread ponder_thread;
+  while (true) {
+    bool has_input = ReadWorld(std::cin, world);
+    auto input_time = std::chrono::high_resolution_clock::now();
+    bool is_new_game = has_input && world.wolff.pos.x == kNewGameMarker;
+    bool is_predicted = is_pondering && has_input && !is_new_game
+        && world.Hash() == predicted.Hash();
+    if (is_pondering) {
+      if (!is_predicted || !Search::kFinishPonderingOnMatch) {
+        stop = true;
+      }
+      ponder_thread.join();
+    }
+    if (!has_input) {
+      break;
+    }
+    if (is_new_game) {
+      is_pondering = false;
+      Search::NewGame();
+      continue;
+    }
+    Command command;
+    if (is_predicted) {
+      command = Search::Resume(world, input_time);
+    } else {
+      command = Search::Decide(world);
+    }
+    std::cout << command << std::endl;
+
+    is_pondering = false;
+    if (ponder) {
+      predicted = world;
+      command.Apply(predicted);
+      predicted.step();
+      if (!predicted.IsGameOver()) {
+        predicted.Init();
+        stop = false;
+        ponder_thread = std::thread([&predicted, &stop] { Search::Ponder(predicted, stop); });
+        is_pondering = true;
+      }
+    }
+  }
+  return 0;
+}
+
+#endif
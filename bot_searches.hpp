@@ -0,0 +1,12 @@
+#ifndef BOT_SEARCHES_H
+#define BOT_SEARCHES_H
+
+// The searches the bots play with, also used by the tools which have to play
+// like the bots do.
+
+#include "bot_framework.hpp"
+
+using TreeBotSearch = TreeSearch<TreeParams<8, 2, 20, 20, 2, 2, true>, EvasiveRollout>;
+using GeneticBotSearch = GeneticSearch<GeneticParams<>, EvasiveRollout>;
+
+#endif
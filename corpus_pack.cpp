@@ -0,0 +1,36 @@
+// Packs test sets (directories of test files or other corpora) into a single
+// scenario corpus file, see scenario.hpp.
+//
+// Usage: ./corpus_pack OUTPUT TEST_SET...
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "scenario.hpp"
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " OUTPUT TEST_SET..." << std::endl;
+    return 1;
+  }
+  std::vector<Scenario> scenarios;
+  for (int i = 2; i < argc; ++i) {
+    std::vector<Scenario> test_set;
+    if (!LoadScenarios(argv[i], test_set)) {
+      std::cerr << "Failed to load " << argv[i] << std::endl;
+      return 1;
+    }
+    if (test_set.empty()) {
+      std::cerr << "No scenarios in " << argv[i] << std::endl;
+      return 1;
+    }
+    scenarios.insert(scenarios.end(), test_set.begin(), test_set.end());
+  }
+  if (!WriteCorpus(argv[1], scenarios)) {
+    std::cerr << "Failed to write " << argv[1] << std::endl;
+    return 1;
+  }
+  std::cerr << "Packed " << scenarios.size() << " scenarios" << std::endl;
+  return 0;
+}
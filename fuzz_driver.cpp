@@ -0,0 +1,71 @@
+// Replays batches of scripted games through the C++ engine for fuzzer.py.
+//
+// Input is a number of cases followed by the cases themselves. Every case is
+// a world in the test file format followed by the number of actions and the
+// actions, one per line: either "MOVE x y" or "SHOOT k" where k is an index
+// into the list of alive enemies (taken modulo its size), so that a script
+// stays valid whichever enemies are killed along the way.
+//
+// For every case a single line with the final state is printed:
+//   score killed turns wolff_x wolff_y
+//   data_points_num [id]... enemies_num [id x y life_points]...
+// The game stops when it is over or when the actions run out.
+
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "world.hpp"
+
+void ApplyAction(World& world, const std::string& type, int a, int b) {
+  if (type == "MOVE") {
+    world.wolff.move(Vector2D(a, b));
+  } else {
+    int index = a % static_cast<int>(world.enemies.size());
+    auto it = world.enemies.begin();
+    std::advance(it, index);
+    world.wolff.shoot(it->id);
+  }
+  world.step();
+}
+
+void PrintState(std::ostream& out, const World& world, int turns) {
+  out << world.score << " " << world.is_wolff_killed << " " << turns << " "
+      << world.wolff.pos.x << " " << world.wolff.pos.y << " "
+      << world.data_points.size();
+  for (const auto& dp : world.data_points) {
+    out << " " << dp.id;
+  }
+  out << " " << world.enemies.size();
+  for (const auto& enemy : world.enemies) {
+    out << " " << enemy.id << " " << enemy.pos.x << " " << enemy.pos.y
+        << " " << enemy.life_points;
+  }
+  out << "\n";
+}
+
+int main() {
+  std::ios::sync_with_stdio(false);
+  int cases_num;
+  std::cin >> cases_num;
+  for (int i = 0; i < cases_num; ++i) {
+    World world;
+    ReadWorld(std::cin, world);
+    int actions_num;
+    std::cin >> actions_num;
+    int turns = 0;
+    for (int j = 0; j < actions_num; ++j) {
+      std::string type;
+      int a = 0, b = 0;
+      std::cin >> type >> a;
+      if (type == "MOVE") {
+        std::cin >> b;
+      }
+      if (!world.IsGameOver()) {
+        ApplyAction(world, type, a, b);
+        ++turns;
+      }
+    }
+    PrintState(std::cout, world, turns);
+  }
+}
@@ -0,0 +1,263 @@
+#!/usr/bin/env python
+
+# Differential fuzzer between the rules in simulator.py and the C++ engine.
+#
+# Random worlds together with random action scripts are run through the
+# Python World and, in batches, through every given engine binary (see
+# fuzz_driver.cpp; build it against any variant of world.cpp). Any case on
+# which an engine disagrees with simulator.py or crashes is minimised and
+# written to the output directory as a scenario file: a world in the test
+# format followed by the action script, which can be checked again with
+# --replay.
+
+import argparse
+import io
+import multiprocessing
+import os
+import random
+import subprocess
+
+import simulator
+
+# Plays a fixed script of actions. SHOOT actions hold an index into the
+# enemies that are still alive rather than an id, see fuzz_driver.cpp.
+class ScriptedBot:
+    def __init__(self, actions):
+        self.actions = actions
+        self.turn = 0
+
+    def make_turn(self, world):
+        action = self.actions[self.turn]
+        self.turn += 1
+        if action[0] == 'MOVE':
+            return list(action)
+        ids = list(world.enemies)
+        return ['SHOOT', ids[action[1] % len(ids)]]
+
+class Case:
+    def __init__(self, wolff, data_points, enemies, actions):
+        self.wolff = wolff
+        self.data_points = data_points
+        self.enemies = enemies
+        self.actions = actions
+
+    def world_text(self):
+        lines = ['{} {}'.format(*self.wolff), str(len(self.data_points))]
+        lines += ['{} {} {}'.format(*p) for p in self.data_points]
+        lines.append(str(len(self.enemies)))
+        lines += ['{} {} {} {}'.format(*e) for e in self.enemies]
+        return '\n'.join(lines) + '\n'
+
+    def serialize(self):
+        lines = [str(len(self.actions))]
+        lines += [' '.join(str(v) for v in a) for a in self.actions]
+        return self.world_text() + '\n'.join(lines) + '\n'
+
+    @staticmethod
+    def deserialize(text):
+        tokens = text.split()
+        pos = 0
+        def take(n):
+            nonlocal pos
+            values = [int(t) if t.lstrip('-').isdigit() else t
+                      for t in tokens[pos:pos + n]]
+            pos += n
+            return values
+        wolff = tuple(take(2))
+        data_points = [tuple(take(3)) for i in range(take(1)[0])]
+        enemies = [tuple(take(4)) for i in range(take(1)[0])]
+        actions = []
+        for i in range(take(1)[0]):
+            action = take(1)
+            action += take(2 if action[0] == 'MOVE' else 1)
+            actions.append(tuple(action))
+        return Case(wolff, data_points, enemies, actions)
+
+OUT_OF_BOUNDS_MARGIN = 2000
+
+def generate_case(rng, max_entities, max_turns):
+    # Coarse coordinates make equal distances and exact hits much more likely,
+    # which is where tie-breaking differences show up.
+    step = 500 if rng.random() < 0.3 else 1
+    def coord(limit):
+        return rng.randrange(0, limit, step)
+    wolff = (coord(simulator.World.WIDTH), coord(simulator.World.HEIGHT))
+    data_points = [(i, coord(simulator.World.WIDTH),
+                    coord(simulator.World.HEIGHT))
+                   for i in range(rng.randint(1, max_entities))]
+    enemies = [(i, coord(simulator.World.WIDTH), coord(simulator.World.HEIGHT),
+                rng.randint(1, simulator.World.MAX_LIFE_POINTS - 1))
+               for i in range(rng.randint(1, max_entities))]
+    # A few moves go out of bounds, up to the edges of the arena included.
+    def move_coord(limit):
+        if rng.random() < 0.02:
+            return rng.randrange(-OUT_OF_BOUNDS_MARGIN,
+                                 limit + OUT_OF_BOUNDS_MARGIN, step)
+        return coord(limit)
+    actions = []
+    for i in range(rng.randint(1, max_turns)):
+        if rng.random() < 0.5:
+            actions.append(('MOVE', move_coord(simulator.World.WIDTH),
+                            move_coord(simulator.World.HEIGHT)))
+        else:
+            actions.append(('SHOOT', rng.randrange(max_entities)))
+    return Case(wolff, data_points, enemies, actions)
+
+def is_out_of_bounds(action):
+    return action[0] == 'MOVE' and not (
+        0 <= action[1] < simulator.World.WIDTH and
+        0 <= action[2] < simulator.World.HEIGHT)
+
+# simulator.py never lets an out of bounds move reach World: Bot.make_turn
+# rejects it, and World.step would simply move Wolff there. The engine is
+# expected to lose the game instead, after the enemies have moved and with
+# Wolff left in place, as the game does.
+def lose_out_of_bounds(world):
+    for e in world.enemies.values():
+        e.move(world)
+    world.is_wolff_killed = True
+    world.score = 0
+
+# Returns the final state of the case in the format of fuzz_driver.cpp.
+def run_python(case):
+    world = simulator.World(ScriptedBot(case.actions))
+    world.deserialize(io.StringIO(case.world_text()))
+    turns = 0
+    while not world.game_over() and turns < len(case.actions):
+        if is_out_of_bounds(case.actions[turns]):
+            lose_out_of_bounds(world)
+        else:
+            world.step()
+        turns += 1
+    values = [world.total_score(), int(world.is_wolff_killed), turns,
+              world.wolff.x, world.wolff.y, len(world.data_points)]
+    values += list(world.data_points)
+    values.append(len(world.enemies))
+    for e in world.enemies.values():
+        values += [e.id, e.x, e.y, e.life_points]
+    return ' '.join(str(v) for v in values)
+
+# Reported as the final state of a case the engine crashed or hung on.
+CRASH = 'crash'
+ENGINE_TIMEOUT_S = 60
+
+# Returns the engine's final state for every case. A batch the engine fails
+# on is bisected down to the cases it fails on alone, which get CRASH.
+def run_engine(engine, cases):
+    input = str(len(cases)) + '\n' + ''.join(c.serialize() for c in cases)
+    try:
+        output = subprocess.run([engine], input=input, stdout=subprocess.PIPE,
+                                stderr=subprocess.DEVNULL,
+                                universal_newlines=True, check=True,
+                                timeout=ENGINE_TIMEOUT_S).stdout
+        lines = output.splitlines()
+    except (subprocess.CalledProcessError, subprocess.TimeoutExpired):
+        lines = []
+    if len(lines) == len(cases):
+        return lines
+    if len(cases) == 1:
+        return [CRASH]
+    mid = len(cases) // 2
+    return run_engine(engine, cases[:mid]) + run_engine(engine, cases[mid:])
+
+# Returns (index, engine, expected, actual) for every disagreement.
+def find_mismatches(cases, engines):
+    expected = [run_python(c) for c in cases]
+    mismatches = []
+    for engine in engines:
+        for i, actual in enumerate(run_engine(engine, cases)):
+            if actual != expected[i]:
+                mismatches.append((i, engine, expected[i], actual))
+    return mismatches
+
+def fails(cases, engine):
+    return [i for i, _, _, _ in find_mismatches(cases, [engine])]
+
+# Shrinks the case while the engine keeps disagreeing with simulator.py. Every
+# round tries all the one-step reductions in a single engine run.
+def minimise(case, engine):
+    while True:
+        candidates = [Case(case.wolff, case.data_points, case.enemies,
+                           case.actions[:n])
+                      for n in range(1, len(case.actions))]
+        for i in range(len(case.data_points)):
+            if len(case.data_points) > 1:
+                candidates.append(Case(case.wolff,
+                                       case.data_points[:i] + case.data_points[i + 1:],
+                                       case.enemies, case.actions))
+        for i in range(len(case.enemies)):
+            if len(case.enemies) > 1:
+                candidates.append(Case(case.wolff, case.data_points,
+                                       case.enemies[:i] + case.enemies[i + 1:],
+                                       case.actions))
+        if not candidates:
+            return case
+        failing = fails(candidates, engine)
+        if not failing:
+            return case
+        case = candidates[failing[0]]
+
+_args = None
+
+def _init_worker(args):
+    global _args
+    _args = args
+
+def _run_batch(batch_id):
+    rng = random.Random(_args.seed * 1000003 + batch_id)
+    cases = [generate_case(rng, _args.max_entities, _args.max_turns)
+             for i in range(_args.batch_size)]
+    return [(cases[i], engine, expected, actual) for i, engine, expected, actual
+            in find_mismatches(cases, _args.engines)]
+
+def replay(path, engines):
+    with open(path) as f:
+        case = Case.deserialize(f.read())
+    print('{:20} {}'.format('simulator.py', run_python(case)))
+    for engine in engines:
+        print('{:20} {}'.format(engine, run_engine(engine, [case])[0]))
+
+def main():
+    parser = argparse.ArgumentParser(
+        usage='./fuzzer.py [options] ENGINE... | --replay FILE ENGINE...')
+    parser.add_argument('engines', nargs='+')
+    parser.add_argument('--cases', type=int, default=100000)
+    parser.add_argument('--batch-size', type=int, default=1000)
+    parser.add_argument('--jobs', type=int, default=multiprocessing.cpu_count())
+    parser.add_argument('--seed', type=int, default=0)
+    parser.add_argument('--max-entities', type=int, default=10)
+    parser.add_argument('--max-turns', type=int, default=40)
+    parser.add_argument('--max-failures', type=int, default=10,
+                        help='number of mismatches to minimise and save')
+    parser.add_argument('--out', default='fuzz_failures')
+    parser.add_argument('--replay', metavar='FILE')
+    args = parser.parse_args()
+    if args.replay:
+        replay(args.replay, args.engines)
+        return
+
+    batches_num = (args.cases + args.batch_size - 1) // args.batch_size
+    mismatches_num = 0
+    saved_num = 0
+    with multiprocessing.Pool(args.jobs, _init_worker, (args,)) as pool:
+        for batch_id, mismatches in enumerate(
+                pool.imap_unordered(_run_batch, range(batches_num))):
+            mismatches_num += len(mismatches)
+            for case, engine, expected, actual in mismatches:
+                if saved_num >= args.max_failures:
+                    break
+                case = minimise(case, engine)
+                os.makedirs(args.out, exist_ok=True)
+                path = os.path.join(args.out, 'case_{}_{}'.format(args.seed,
+                                                                  saved_num))
+                with open(path, 'w') as f:
+                    f.write(case.serialize())
+                saved_num += 1
+                print('Mismatch with {} saved to {}'.format(engine, path))
+            print('{} cases, {} mismatches'.format(
+                min(args.cases, (batch_id + 1) * args.batch_size),
+                mismatches_num), end='\r')
+    print()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,83 @@
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+// Actions for the first turns of known scenarios, found offline by
+// opening_book_builder with a much deeper search than a bot can afford
+// during the game. Entries are keyed by World::Hash of the world the bot
+// reads on that turn, so a game stays in the book only as long as it
+// follows it.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "bot_framework.hpp"
+
+struct OpeningBookEntry {
+  uint64_t hash;
+  int type;
+  // Target position for MOVE, target id (in x) for SHOOT.
+  int x, y;
+};
+
+// Defines kOpeningBook, a std::array of entries sorted by hash.
+#include "opening_book_table.inc"
+
+inline bool LookupOpeningBook(const World& world, Command& command) {
+  uint64_t hash = world.Hash();
+  auto it = std::lower_bound(
+      kOpeningBook.begin(), kOpeningBook.end(), hash,
+      [](const OpeningBookEntry& entry, uint64_t h) { return entry.hash < h; });
+  if (it == kOpeningBook.end() || it->hash != hash) {
+    return false;
+  }
+  if (it->type == Command::MOVE) {
+    command = Command::Move(Vector2D(it->x, it->y));
+  } else {
+    command = Command::Shoot(it->x);
+  }
+  return true;
+}
+
+// Plays from the opening book while the game is in it and falls back to the
+// live search otherwise.
+template <class Search>
+struct WithOpeningBook {
+  static std::string Name() {
+    return "book " + Search::Name();
+  }
+
+  static void NewGame() {
+    Search::NewGame();
+  }
+
+  static Command Decide(const World& world) {
+    Command command;
+    if (LookupOpeningBook(world, command)) {
+      return command;
+    }
+    return Search::Decide(world);
+  }
+
+  static constexpr bool kFinishPonderingOnMatch = Search::kFinishPonderingOnMatch;
+
+  static void Ponder(const World& world, const std::atomic<bool>& stop) {
+    Command command;
+    if (!LookupOpeningBook(world, command)) {
+      Search::Ponder(world, stop);
+    }
+  }
+
+  static Command Resume(const World& world,
+                        std::chrono::high_resolution_clock::time_point start) {
+    Command command;
+    if (LookupOpeningBook(world, command)) {
+      return command;
+    }
+    return Search::Resume(world, start);
+  }
+};
+
+#endif
@@ -0,0 +1,108 @@
+// Builds opening_book_table.inc for opening_book.hpp.
+//
+// For every scenario of the test set the first TURNS turns are played with
+// each of the deep searches below and the rest of the game with the live
+// search of bot.cpp. The opening of the best such game goes into the book if
+// it beats playing the whole game with the live search. bot_ga.cpp shares the
+// book without it being checked against its own search.
+//
+// All the searches are deterministic, so the output only depends on the test
+// set and TURNS.
+//
+// Usage: ./opening_book_builder TEST_SET [TURNS] > opening_book_table.inc
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+
+#include "bot_framework.hpp"
+#include "bot_searches.hpp"
+#include "opening_book.hpp"
+#include "scenario.hpp"
+
+using LiveSearch = TreeBotSearch;
+
+struct Opening {
+  int score = 0;
+  std::vector<OpeningBookEntry> entries;
+};
+
+// Plays the first turns_num turns with Deep and the rest with LiveSearch.
+template <class Deep>
+Opening PlayOpening(World world, int turns_num) {
+  Opening opening;
+  Deep::NewGame();
+  for (int turn = 0; turn < turns_num && !world.IsGameOver(); ++turn) {
+    World view = world;
+    view.Init();
+    Command command = Deep::Decide(view);
+    OpeningBookEntry entry;
+    entry.hash = view.Hash();
+    entry.type = command.type;
+    entry.x = command.type == Command::MOVE ? command.target.x : command.target_id;
+    entry.y = command.type == Command::MOVE ? command.target.y : 0;
+    opening.entries.push_back(entry);
+    command.Apply(world);
+    world.step();
+  }
+  opening.score = world.IsGameOver() ? world.score : PlayGame<LiveSearch>(world).score;
+  return opening;
+}
+
+using DeepOpening = Opening (*)(World world, int turns_num);
+
+const DeepOpening kDeepSearches[] = {
+  PlayOpening<TreeSearch<TreeParams<16, 2, 200, 200>, EvasiveRollout>>,
+  PlayOpening<TreeSearch<TreeParams<8, 3, 200, 200>, EvasiveRollout>>,
+  PlayOpening<TreeSearch<TreeParams<24, 2, 200, 200>, EvasiveRollout>>,
+  // Seeded by NewGame and bounded by generations rather than time.
+  PlayOpening<GeneticSearch<GeneticParams<200, 16, INT_MAX, 100, 100, 1, 150>,
+                            EvasiveRollout>>,
+};
+
+int main(int argc, char** argv) {
+  if (argc != 2 && argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " TEST_SET [TURNS]" << std::endl;
+    return 1;
+  }
+  int turns_num = argc == 3 ? std::stoi(argv[2]) : 5;
+  std::vector<Scenario> scenarios;
+  if (!LoadScenarios(argv[1], scenarios)) {
+    std::cerr << "Failed to load " << argv[1] << std::endl;
+    return 1;
+  }
+  std::vector<OpeningBookEntry> book;
+  for (const auto& scenario : scenarios) {
+    int live_score = PlayGame<LiveSearch>(scenario.world).score;
+    Opening best;
+    best.score = live_score;
+    for (auto play : kDeepSearches) {
+      Opening opening = play(scenario.world, turns_num);
+      if (opening.score > best.score) {
+        best = opening;
+      }
+    }
+    std::cerr << scenario.name << ": " << live_score << " -> " << best.score << std::endl;
+    book.insert(book.end(), best.entries.begin(), best.entries.end());
+  }
+  std::sort(book.begin(), book.end(),
+            [](const OpeningBookEntry& a, const OpeningBookEntry& b) { return a.hash < b.hash; });
+  // Two scenarios can pass through the same world, keep the first entry.
+  book.erase(std::unique(book.begin(), book.end(),
+                         [](const OpeningBookEntry& a, const OpeningBookEntry& b) {
+                           return a.hash == b.hash;
+                         }),
+             book.end());
+
+  std::cout << "// Generated by opening_book_builder, do not edit.\n";
+  std::cout << "const std::array<OpeningBookEntry, " << book.size() << "> kOpeningBook = {{\n";
+  for (const auto& entry : book) {
+    char hash[32];
+    snprintf(hash, sizeof(hash), "0x%016llxULL", static_cast<unsigned long long>(entry.hash));
+    std::cout << "  {" << hash << ", " << entry.type << ", " << entry.x << ", " << entry.y << "},\n";
+  }
+  std::cout << "}};\n";
+}
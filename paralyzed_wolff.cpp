@@ -4,11 +4,19 @@
 #include <algorithm>
 #include <climits>
 
+#include "world.hpp"
+
 int main() {
   while (true) {
     int x;
     int y;
-    std::cin >> x >> y; std::cin.ignore();
+    if (!(std::cin >> x >> y)) {
+      return 0;
+    }
+    std::cin.ignore();
+    if (x == kNewGameMarker) {
+      continue;
+    }
     int dataCount;
     std::cin >> dataCount; std::cin.ignore();
     for (int i = 0; i < dataCount; i++) {
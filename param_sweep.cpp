@@ -0,0 +1,156 @@
+// Plays every test of a test set in-process with a number of bot
+// configurations and prints their scores and timings side by side.
+//
+// Usage: ./param_sweep TEST_SET
+//        ./param_sweep --list TEST_SET
+//        ./param_sweep --run CONFIG TEST_SET SCENARIO...
+//
+// --list prints the number of scenarios and the configurations, --run plays
+// the given scenarios with one configuration and prints a single line
+//   score turns total_ms max_turn_ms
+// for tuner.py.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "bot_framework.hpp"
+#include "scenario.hpp"
+
+struct Config {
+  std::string (*name)();
+  GameResult (*play)(World world);
+};
+
+template <class Search>
+constexpr Config MakeConfig() {
+  return {Search::Name, PlayGame<Search>};
+}
+
+template <int kAngleStepsNum, int kSearchDepth, int kMaxEnemies,
+          int kRefineRounds = 0, int kRefineCandidates = 2, bool kClampToArena = false>
+using Tree = TreeSearch<TreeParams<kAngleStepsNum, kSearchDepth, kMaxEnemies, kMaxEnemies,
+                                   kRefineRounds, kRefineCandidates, kClampToArena>,
+                        EvasiveRollout>;
+
+template <int kPopulationSize, int kMovesNum, int kTimeLimitMs,
+          int kMutationPercent = 100, int kRecombinationsPercent = 100>
+using Genetic = GeneticSearch<GeneticParams<kPopulationSize, kMovesNum, kTimeLimitMs,
+                                            kMutationPercent, kRecombinationsPercent>,
+                              EvasiveRollout>;
+
+const Config kConfigs[] = {
+  MakeConfig<Tree<4, 1, 20>>(),
+  MakeConfig<Tree<4, 2, 20>>(),
+  MakeConfig<Tree<8, 1, 20>>(),
+  MakeConfig<Tree<8, 2, 10>>(),
+  MakeConfig<Tree<8, 2, 20>>(),
+  MakeConfig<Tree<8, 2, 30>>(),
+  MakeConfig<Tree<12, 2, 20>>(),
+  MakeConfig<Tree<16, 1, 20>>(),
+  MakeConfig<Tree<16, 2, 20>>(),
+  MakeConfig<Tree<8, 3, 10>>(),
+  MakeConfig<Tree<8, 2, 20, 0, 2, true>>(),
+  MakeConfig<Tree<8, 2, 20, 1, 2, true>>(),
+  MakeConfig<Tree<8, 2, 20, 2, 2, true>>(),
+  MakeConfig<Tree<8, 2, 20, 3, 3, true>>(),
+  MakeConfig<Tree<4, 2, 20, 2, 2, true>>(),
+  MakeConfig<Tree<4, 2, 20, 3, 2, true>>(),
+  MakeConfig<Tree<8, 2, 30, 2, 2, true>>(),
+  MakeConfig<Tree<8, 2, 40, 2, 2, true>>(),
+  MakeConfig<Tree<12, 2, 20, 2, 2, true>>(),
+  MakeConfig<Tree<12, 2, 30, 2, 3, true>>(),
+  MakeConfig<Tree<16, 2, 20, 2, 2, true>>(),
+  MakeConfig<Tree<8, 3, 10, 2, 2, true>>(),
+  MakeConfig<Genetic<50, 4, 20>>(),
+  MakeConfig<Genetic<100, 4, 20>>(),
+  MakeConfig<Genetic<100, 8, 20>>(),
+  MakeConfig<Genetic<100, 4, 80>>(),
+  MakeConfig<Genetic<200, 8, 80>>(),
+  MakeConfig<Genetic<50, 4, 40>>(),
+  MakeConfig<Genetic<100, 4, 40>>(),
+  MakeConfig<Genetic<100, 8, 40>>(),
+  MakeConfig<Genetic<100, 4, 80, 50, 100>>(),
+  MakeConfig<Genetic<100, 4, 80, 100, 50>>(),
+  MakeConfig<Genetic<100, 4, 80, 200, 50>>(),
+  MakeConfig<Genetic<50, 8, 80, 200, 100>>(),
+};
+
+constexpr int kConfigsNum = sizeof(kConfigs) / sizeof(kConfigs[0]);
+
+// Returns the total result of playing the scenarios with the configuration.
+GameResult Play(const Config& config, const std::vector<Scenario>& scenarios) {
+  GameResult total;
+  for (const auto& scenario : scenarios) {
+    GameResult result = config.play(scenario.world);
+    total.score += result.score;
+    total.turns += result.turns;
+    total.total_ms += result.total_ms;
+    total.max_turn_ms = std::max(total.max_turn_ms, result.max_turn_ms);
+  }
+  return total;
+}
+
+// Loads the test set or reports why it can't.
+bool LoadTestSet(const std::string& path, std::vector<Scenario>& scenarios) {
+  if (!LoadScenarios(path, scenarios)) {
+    std::cerr << "Failed to load " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  std::string mode = argc > 1 ? argv[1] : "";
+  if (mode == "--list" && argc == 3) {
+    std::vector<Scenario> scenarios;
+    if (!LoadTestSet(argv[2], scenarios)) {
+      return 1;
+    }
+    std::cout << "scenarios " << scenarios.size() << std::endl;
+    for (int i = 0; i < kConfigsNum; ++i) {
+      std::cout << i << " " << kConfigs[i].name() << std::endl;
+    }
+    return 0;
+  }
+  if (mode == "--run" && argc >= 4) {
+    int config_id = std::stoi(argv[2]);
+    if (config_id < 0 || config_id >= kConfigsNum) {
+      std::cerr << "No such configuration" << std::endl;
+      return 1;
+    }
+    std::vector<size_t> ids;
+    for (int i = 4; i < argc; ++i) {
+      ids.push_back(std::stoul(argv[i]));
+    }
+    // Only the requested scenarios are read, tuner.py runs many small jobs.
+    std::vector<Scenario> scenarios;
+    if (!LoadScenarios(argv[3], ids, scenarios)) {
+      std::cerr << "Failed to load the scenarios from " << argv[3] << std::endl;
+      return 1;
+    }
+    GameResult result = Play(kConfigs[config_id], scenarios);
+    std::cout << result.score << " " << result.turns << " " << result.total_ms
+              << " " << result.max_turn_ms << std::endl;
+    return 0;
+  }
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " TEST_SET" << std::endl;
+    std::cerr << "       " << argv[0] << " --list TEST_SET" << std::endl;
+    std::cerr << "       " << argv[0] << " --run CONFIG TEST_SET SCENARIO..." << std::endl;
+    return 1;
+  }
+  std::vector<Scenario> scenarios;
+  if (!LoadTestSet(argv[1], scenarios)) {
+    return 1;
+  }
+  std::cout << std::fixed << std::setprecision(2);
+  for (const auto& config : kConfigs) {
+    GameResult result = Play(config, scenarios);
+    std::cout << std::setw(70) << std::left << config.name()
+              << " score: " << std::setw(6) << result.score
+              << " avg turn: " << result.total_ms / std::max(result.turns, 1) << "ms"
+              << " max turn: " << result.max_turn_ms << "ms" << std::endl;
+  }
+}
@@ -4,13 +4,22 @@
 #include <algorithm>
 #include <climits>
 
+#include "world.hpp"
+
 int main() {
   int it_id = 0;
   while (true) {
-    ++it_id;
     int x;
     int y;
-    std::cin >> x >> y; std::cin.ignore();
+    if (!(std::cin >> x >> y)) {
+      return 0;
+    }
+    std::cin.ignore();
+    if (x == kNewGameMarker) {
+      it_id = 0;
+      continue;
+    }
+    ++it_id;
     int dataCount;
     std::cin >> dataCount; std::cin.ignore();
     for (int i = 0; i < dataCount; i++) {
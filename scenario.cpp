@@ -0,0 +1,208 @@
+#include "scenario.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+size_t GetRecordSize(const CorpusRecord& record) {
+  return sizeof(CorpusRecord)
+      + sizeof(int32_t) * (3 * static_cast<size_t>(record.data_points_num)
+                           + 4 * static_cast<size_t>(record.enemies_num))
+      + (static_cast<size_t>(record.name_length) + 3) / 4 * 4;
+}
+
+}  // namespace
+
+ScenarioCorpus::~ScenarioCorpus() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), data_size_);
+  }
+}
+
+bool ScenarioCorpus::Open(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(CorpusHeader)) {
+    close(fd);
+    return false;
+  }
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  data_ = static_cast<const char*>(data);
+  data_size_ = st.st_size;
+
+  const auto* header = reinterpret_cast<const CorpusHeader*>(data_);
+  if (memcmp(header->magic, kCorpusMagic, sizeof(kCorpusMagic)) != 0
+      || header->version != kCorpusVersion
+      || header->scenarios_num > (data_size_ - sizeof(CorpusHeader)) / sizeof(uint64_t)) {
+    return false;
+  }
+  offsets_ = reinterpret_cast<const uint64_t*>(data_ + sizeof(CorpusHeader));
+  for (size_t i = 0; i < header->scenarios_num; ++i) {
+    if (offsets_[i] % alignof(CorpusRecord) != 0
+        || offsets_[i] + sizeof(CorpusRecord) > data_size_) {
+      return false;
+    }
+    const auto& record = *reinterpret_cast<const CorpusRecord*>(data_ + offsets_[i]);
+    if (record.data_points_num < 0 || record.enemies_num < 0 || record.name_length < 0
+        || offsets_[i] + GetRecordSize(record) > data_size_) {
+      return false;
+    }
+  }
+  scenarios_num_ = header->scenarios_num;
+  return true;
+}
+
+const CorpusRecord& ScenarioCorpus::GetRecord(size_t i) const {
+  return *reinterpret_cast<const CorpusRecord*>(data_ + offsets_[i]);
+}
+
+std::string ScenarioCorpus::GetName(size_t i) const {
+  const auto& record = GetRecord(i);
+  const char* name = reinterpret_cast<const char*>(&record + 1)
+      + sizeof(int32_t) * (3 * record.data_points_num + 4 * record.enemies_num);
+  return std::string(name, record.name_length);
+}
+
+void ScenarioCorpus::GetWorld(size_t i, World& world) const {
+  const auto& record = GetRecord(i);
+  const auto* values = reinterpret_cast<const int32_t*>(&record + 1);
+  world = World();
+  world.wolff.pos.x = record.wolff_x;
+  world.wolff.pos.y = record.wolff_y;
+  for (int j = 0; j < record.data_points_num; ++j, values += 3) {
+    world.data_points.push_back(DataPoint(values[0], values[1], values[2]));
+  }
+  for (int j = 0; j < record.enemies_num; ++j, values += 4) {
+    world.enemies.push_back(Enemy(values[0], values[1], values[2], values[3]));
+  }
+  world.Init();
+}
+
+bool WriteCorpus(const std::string& path, const std::vector<Scenario>& scenarios) {
+  std::vector<char> data(sizeof(CorpusHeader) + sizeof(uint64_t) * scenarios.size());
+  auto* header = reinterpret_cast<CorpusHeader*>(data.data());
+  memcpy(header->magic, kCorpusMagic, sizeof(kCorpusMagic));
+  header->version = kCorpusVersion;
+  header->scenarios_num = scenarios.size();
+  std::vector<uint64_t> offsets;
+  for (const auto& scenario : scenarios) {
+    offsets.push_back(data.size());
+    const World& world = scenario.world;
+    std::vector<int32_t> values = {
+      world.wolff.pos.x, world.wolff.pos.y,
+      static_cast<int32_t>(world.data_points.size()),
+      static_cast<int32_t>(world.enemies.size()),
+      static_cast<int32_t>(scenario.name.size())};
+    for (const auto& dp : world.data_points) {
+      values.insert(values.end(), {dp.id, dp.pos.x, dp.pos.y});
+    }
+    for (const auto& enemy : world.enemies) {
+      values.insert(values.end(), {enemy.id, enemy.pos.x, enemy.pos.y, enemy.life_points});
+    }
+    const char* bytes = reinterpret_cast<const char*>(values.data());
+    data.insert(data.end(), bytes, bytes + sizeof(int32_t) * values.size());
+    data.insert(data.end(), scenario.name.begin(), scenario.name.end());
+    data.resize((data.size() + 3) / 4 * 4);
+  }
+  memcpy(data.data() + sizeof(CorpusHeader), offsets.data(), sizeof(uint64_t) * offsets.size());
+  std::ofstream out(path, std::ios::binary);
+  out.write(data.data(), data.size());
+  return static_cast<bool>(out);
+}
+
+namespace {
+
+// Lists the regular files of the test set directory ordered by name.
+bool ListTestFiles(const std::string& path, std::vector<std::filesystem::path>& files) {
+  std::error_code error;
+  for (std::filesystem::directory_iterator it(path, error), end; !error && it != end;
+       it.increment(error)) {
+    if (it->is_regular_file()) {
+      files.push_back(it->path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return !error;
+}
+
+bool ReadTestFile(const std::filesystem::path& file, Scenario& scenario) {
+  std::ifstream in(file);
+  scenario.name = file.filename().string();
+  return ReadWorld(in, scenario.world);
+}
+
+}  // namespace
+
+bool LoadScenarios(const std::string& path, std::vector<Scenario>& scenarios) {
+  scenarios.clear();
+  std::error_code error;
+  if (std::filesystem::is_regular_file(path, error)) {
+    ScenarioCorpus corpus;
+    if (!corpus.Open(path)) {
+      return false;
+    }
+    scenarios.resize(corpus.size());
+    for (size_t i = 0; i < corpus.size(); ++i) {
+      scenarios[i].name = corpus.GetName(i);
+      corpus.GetWorld(i, scenarios[i].world);
+    }
+    return true;
+  }
+  std::vector<std::filesystem::path> files;
+  if (!ListTestFiles(path, files)) {
+    return false;
+  }
+  scenarios.resize(files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (!ReadTestFile(files[i], scenarios[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoadScenarios(const std::string& path, const std::vector<size_t>& ids,
+                   std::vector<Scenario>& scenarios) {
+  scenarios.clear();
+  scenarios.resize(ids.size());
+  std::error_code error;
+  if (std::filesystem::is_regular_file(path, error)) {
+    ScenarioCorpus corpus;
+    if (!corpus.Open(path)) {
+      return false;
+    }
+    for (size_t i = 0; i < ids.size(); ++i) {
+      if (ids[i] >= corpus.size()) {
+        return false;
+      }
+      scenarios[i].name = corpus.GetName(ids[i]);
+      corpus.GetWorld(ids[i], scenarios[i].world);
+    }
+    return true;
+  }
+  std::vector<std::filesystem::path> files;
+  if (!ListTestFiles(path, files)) {
+    return false;
+  }
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (ids[i] >= files.size() || !ReadTestFile(files[ids[i]], scenarios[i])) {
+      return false;
+    }
+  }
+  return true;
+}
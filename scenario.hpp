@@ -0,0 +1,77 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "world.hpp"
+
+struct Scenario {
+  std::string name;
+  World world;
+};
+
+// Packed scenario corpus, all numbers are little-endian:
+//   CorpusHeader
+//   uint64_t offsets[scenarios_num]    // of the records, from file start
+//   records, each of them a CorpusRecord followed by
+//     int32_t data_points[data_points_num][3]    // id x y
+//     int32_t enemies[enemies_num][4]            // id x y life_points
+//     char name[name_length], zero padded to a multiple of 4
+constexpr char kCorpusMagic[4] = {'A', 'C', 'C', 'P'};
+constexpr uint32_t kCorpusVersion = 1;
+
+struct CorpusHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t scenarios_num;
+};
+
+struct CorpusRecord {
+  int32_t wolff_x, wolff_y;
+  int32_t data_points_num;
+  int32_t enemies_num;
+  int32_t name_length;
+};
+
+// Read-only view of a memory mapped corpus file.
+class ScenarioCorpus {
+ public:
+  ScenarioCorpus() {}
+  ~ScenarioCorpus();
+  ScenarioCorpus(const ScenarioCorpus&) = delete;
+  ScenarioCorpus& operator=(const ScenarioCorpus&) = delete;
+
+  // Returns false if the file can't be mapped or isn't a valid corpus.
+  bool Open(const std::string& path);
+  size_t size() const {
+    return scenarios_num_;
+  }
+  std::string GetName(size_t i) const;
+  // Fills the world with the i-th scenario and calls World::Init on it.
+  void GetWorld(size_t i, World& world) const;
+
+ private:
+  const CorpusRecord& GetRecord(size_t i) const;
+
+  const char* data_ = nullptr;
+  size_t data_size_ = 0;
+  size_t scenarios_num_ = 0;
+  const uint64_t* offsets_ = nullptr;
+};
+
+bool WriteCorpus(const std::string& path, const std::vector<Scenario>& scenarios);
+
+// Loads every test file of the test set directory, ordered by file name, or
+// every scenario of a corpus file. Returns false if the path is neither a
+// directory nor a valid corpus, or if one of its test files can't be read.
+bool LoadScenarios(const std::string& path, std::vector<Scenario>& scenarios);
+// Loads only the scenarios with the given indices in the order above, without
+// reading the rest of the test set. Returns false also if an index is out of
+// range.
+bool LoadScenarios(const std::string& path, const std::vector<size_t>& ids,
+                   std::vector<Scenario>& scenarios);
+
+#endif
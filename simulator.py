@@ -5,6 +5,8 @@ import math
 import subprocess
 import sys
 import os
+import argparse
+import multiprocessing
 
 class Unit:
     def __init__(self, speed):
@@ -220,12 +222,25 @@ class World:
         self.initial_life_points_sum = sum(
             [e.life_points for e in self.enemies.values()])
 
+# Sent instead of Wolff's position to tell a persistent bot that the previous
+# game is over and a new one starts with the next turn. The bot doesn't reply.
+# Has to match kNewGameMarker in world.hpp.
+NEW_GAME_MARKER = '-1 -1\n'
+
 # Provides an interface for an actual bot written in C++.
 class Bot:
     def __init__(self, prog_name):
         self.proc = subprocess.Popen(prog_name, shell=True,
                                      stdin=subprocess.PIPE,
                                      stdout=subprocess.PIPE)
+
+    def new_game(self):
+        self.proc.stdin.write(bytes(NEW_GAME_MARKER, encoding='utf8'))
+        self.proc.stdin.flush()
+
+    def close(self):
+        self.proc.terminate()
+
     def make_turn(self, world):
         if self.proc.poll():
             raise Exception('Bot process terminated!')
@@ -251,6 +266,33 @@ class Bot:
         else:
             raise Exception('Unknown command: {}'.format(cmd))
 
+# Hands out a bot for every game. By default each game gets a fresh process,
+# in persistent mode a single process is reused and told about game
+# boundaries with NEW_GAME_MARKER.
+class BotProvider:
+    def __init__(self, prog_name, persistent=False):
+        self.prog_name = prog_name
+        self.persistent = persistent
+        self.bot = None
+
+    def acquire(self):
+        if not self.persistent:
+            return Bot(self.prog_name)
+        if self.bot is None:
+            self.bot = Bot(self.prog_name)
+        else:
+            self.bot.new_game()
+        return self.bot
+
+    def release(self, bot):
+        if not self.persistent:
+            bot.close()
+
+    def close(self):
+        if self.bot is not None:
+            self.bot.close()
+            self.bot = None
+
 def list_tests(test_set):
     files = os.listdir(os.path.join(os.getcwd(), test_set))
     files.sort()
@@ -266,42 +308,88 @@ def run_test(world, test_path):
 def get_test_name(test_path):
     return os.path.split(test_path)[-1]
 
-def run_shoot_tests():
+class TestResult:
+    def __init__(self, test, world):
+        self.test = test
+        self.total_score = world.total_score()
+        self.bonus = world.bonus
+        self.is_wolff_killed = world.is_wolff_killed
+
+def run_tests_with_provider(provider, tests):
+    world = World(None)
+    results = []
+    for test in tests:
+        world.bot = provider.acquire()
+        run_test(world, test)
+        provider.release(world.bot)
+        world.bot = None
+        results.append(TestResult(test, world))
+    return results
+
+# Every pool worker keeps its own provider, so in persistent mode there is one
+# bot process per worker which lives as long as the worker does.
+_worker_provider = None
+
+def _init_worker(prog_name, persistent):
+    global _worker_provider
+    _worker_provider = BotProvider(prog_name, persistent)
+
+def _run_worker_test(test):
+    return run_tests_with_provider(_worker_provider, [test])[0]
+
+# Runs every test with the given bot and returns a TestResult per test in the
+# order of tests.
+def run_tests(tests, prog_name, persistent=False, jobs=1):
+    if jobs <= 1:
+        provider = BotProvider(prog_name, persistent)
+        try:
+            return run_tests_with_provider(provider, tests)
+        finally:
+            provider.close()
+    # Bots exit on their own once the worker goes away and closes their stdin.
+    with multiprocessing.Pool(jobs, _init_worker,
+                              (prog_name, persistent)) as pool:
+        return pool.map(_run_worker_test, tests, chunksize=1)
+
+def add_harness_arguments(parser):
+    parser.add_argument('--persistent', action='store_true',
+                        help='reuse one bot process for all the games a '
+                        'worker runs; the bot must support NEW_GAME_MARKER')
+    parser.add_argument('--jobs', type=int, default=1,
+                        help='number of games to run in parallel')
+
+def run_shoot_tests(persistent=False):
     expected_scores = (110, 220, 120, 120, 148, 311, 450, 60, 510, 90,
                        406, 0, 220, 346, 770, 342, 0, 120, 120, 136,
                        152, 0, 110, 110, 260, 60, 240, 320, 339, 160,
                        0, 2220)
     tests = list_tests('public_tests')
-    world = World(None)
+    results = run_tests(tests, './paralyzed_wolff', persistent)
     all_tests_pass = True
-    for expected_score, test in zip(expected_scores, tests):
-        world.bot = Bot('./paralyzed_wolff')
-        run_test(world, test)
-        world.bot.proc.terminate()
-        if world.total_score() != expected_score:
+    for expected_score, result in zip(expected_scores, results):
+        if result.total_score != expected_score:
             all_tests_pass = False
             print('Test {} failed. Expected score {}, got {}'.format(
-                get_test_name(test), expected_score, world.total_score()))
+                get_test_name(result.test), expected_score,
+                result.total_score))
             break
     if all_tests_pass:
         print('All shooting tests passed successfully :)')
 
-def run_move_tests():
+def run_move_tests(persistent=False):
     expected_scores = (113, 126, 144, 144, 0, 20, 0, 0, 0, 0,
                        0, 0, 126, 0, 200, 20, 0, 120, 144, 163,
                        0, 0, 310, 310, 0, 0, 140, 620, 874, 0,
                        0, 0)
     tests = list_tests('public_tests')
-    world = World(None)
+    results = run_tests(tests, './partially_paralyzed_wolff', persistent)
     all_tests_pass = True
-    for expected_score, test in zip(expected_scores, tests):
-        world.bot = Bot('./partially_paralyzed_wolff')
-        run_test(world, test)
-        world.bot.proc.terminate()
-        if world.total_score() != expected_score:
+    for expected_score, result in zip(expected_scores, results):
+        if result.total_score != expected_score:
             all_tests_pass = False
             print('Test {} failed. Expected score {}, got {}'.format(
-                get_test_name(test), expected_score, world.total_score()))
+                get_test_name(result.test), expected_score,
+                result.total_score))
             break
     if all_tests_pass:
         print('All moving tests passed successfully :)')
@@ -309,31 +397,27 @@ def run_move_tests():
 def main():
     #run_shoot_tests()
     #run_move_tests()
-    if len(sys.argv) != 3:
-        print('Please use the following format:')
-        print('./simulator.py TEST_SET BOT_PROGRAM')
-    else:
-        test_set = sys.argv[1]
-        bot_program = sys.argv[2]
-        tests = list_tests(test_set)
-        world = World(None)
-        scores_sum = 0
-        positive_bonus_num = 0
-        bonuses_sum = 0
-        for test in tests:
-            world.bot = Bot(bot_program)
-            run_test(world, test)
-            world.bot.proc.terminate()
-            world.bot = None
-            scores_sum += world.total_score()
-            bonuses_sum += world.bonus
-            if world.bonus > 0:
-                positive_bonus_num += 1
-            print('{:31} score: {}, bonus: {} {}'.format(get_test_name(test),
-                  world.total_score(), world.bonus,
-                  '(killed)' if world.is_wolff_killed else ''))
-        print('Sum: {}, Bonus: {} ({:0.4}%)'.format(scores_sum, bonuses_sum, bonuses_sum / scores_sum * 100))
-        print('Positive bonus: {:0.4}%'.format(positive_bonus_num / len(tests) * 100))
+    parser = argparse.ArgumentParser(
+        usage='./simulator.py [--persistent] [--jobs N] TEST_SET BOT_PROGRAM')
+    parser.add_argument('test_set')
+    parser.add_argument('bot_program')
+    add_harness_arguments(parser)
+    args = parser.parse_args()
+    tests = list_tests(args.test_set)
+    results = run_tests(tests, args.bot_program, args.persistent, args.jobs)
+    scores_sum = 0
+    positive_bonus_num = 0
+    bonuses_sum = 0
+    for result in results:
+        scores_sum += result.total_score
+        bonuses_sum += result.bonus
+        if result.bonus > 0:
+            positive_bonus_num += 1
+        print('{:31} score: {}, bonus: {} {}'.format(get_test_name(result.test),
+              result.total_score, result.bonus,
+              '(killed)' if result.is_wolff_killed else ''))
+    print('Sum: {}, Bonus: {} ({:0.4}%)'.format(scores_sum, bonuses_sum, bonuses_sum / scores_sum * 100))
+    print('Positive bonus: {:0.4}%'.format(positive_bonus_num / len(tests) * 100))
 
 if __name__ == '__main__':
     main()
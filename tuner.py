@@ -0,0 +1,198 @@
+#!/usr/bin/env python
+
+# Tunes the bot configurations compiled into param_sweep.cpp with successive
+# halving: every round plays the surviving configurations on a larger random
+# sample of scenarios, in parallel, drops those whose slowest turn exceeds the
+# latency ceiling and keeps the best 1/ETA of the rest by score. The best
+# configuration and the score/latency trade-off of everything evaluated are
+# written as JSON.
+#
+# Every worker is pinned to a core of its own, but turns timed next to other
+# jobs still run slower (shared caches, memory bandwidth, hyperthread
+# siblings). So a configuration over the ceiling is timed again on its own
+# before it is dropped, and the best one is only reported once its latency on
+# the whole test set has been checked the same way.
+
+import argparse
+import json
+import multiprocessing
+import os
+import random
+import subprocess
+import sys
+
+class Evaluation:
+    def __init__(self):
+        self.scenarios_num = 0
+        self.score = 0
+        self.turns = 0
+        self.total_ms = 0.0
+        self.max_turn_ms = 0.0
+
+    def add(self, line):
+        score, turns, total_ms, max_turn_ms = line.split()
+        self.score += int(score)
+        self.turns += int(turns)
+        self.total_ms += float(total_ms)
+        self.max_turn_ms = max(self.max_turn_ms, float(max_turn_ms))
+
+    def mean_score(self):
+        return self.score / max(self.scenarios_num, 1)
+
+    def to_dict(self):
+        return {'scenarios': self.scenarios_num,
+                'mean_score': self.mean_score(),
+                'avg_turn_ms': self.total_ms / max(self.turns, 1),
+                'max_turn_ms': self.max_turn_ms}
+
+def list_configs(sweep, test_set):
+    output = subprocess.run([sweep, '--list', test_set], stdout=subprocess.PIPE,
+                            universal_newlines=True, check=True).stdout
+    lines = output.splitlines()
+    scenarios_num = int(lines[0].split()[1])
+    configs = [line.split(' ', 1)[1] for line in lines[1:]]
+    return scenarios_num, configs
+
+def _run_job(job):
+    sweep, config_id, test_set, scenarios = job
+    output = subprocess.run(
+        [sweep, '--run', str(config_id), test_set] + [str(s) for s in scenarios],
+        stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+    return config_id, output
+
+def _init_worker(cpus):
+    os.sched_setaffinity(0, {cpus.get()})
+
+# Returns a pool of at most one worker per available core, each pinned to it.
+def make_pool(jobs):
+    if not hasattr(os, 'sched_setaffinity'):
+        return multiprocessing.Pool(jobs)
+    cpus = sorted(os.sched_getaffinity(0))[:jobs]
+    queue = multiprocessing.Queue()
+    for cpu in cpus:
+        queue.put(cpu)
+    return multiprocessing.Pool(len(cpus), _init_worker, (queue,))
+
+def evaluate(pool, args, config_ids, scenarios):
+    chunks = [scenarios[i:i + args.chunk_size]
+              for i in range(0, len(scenarios), args.chunk_size)]
+    jobs = [(args.sweep, config_id, args.test_set, chunk)
+            for config_id in config_ids for chunk in chunks]
+    evaluations = {config_id: Evaluation() for config_id in config_ids}
+    for config_id, output in pool.imap_unordered(_run_job, jobs):
+        evaluations[config_id].add(output)
+    for evaluation in evaluations.values():
+        evaluation.scenarios_num = len(scenarios)
+    return evaluations
+
+# Checks the slowest turn of the evaluation against the ceiling. If it is over,
+# the configuration is timed again on the same scenarios with nothing else
+# running and the evaluation takes that time.
+def fits_latency(args, config_id, evaluation, scenarios):
+    if evaluation.max_turn_ms <= args.latency_ms:
+        return True
+    serial = Evaluation()
+    serial.add(_run_job((args.sweep, config_id, args.test_set, scenarios))[1])
+    evaluation.max_turn_ms = serial.max_turn_ms
+    return evaluation.max_turn_ms <= args.latency_ms
+
+# Configurations which no other one beats on both mean score and slowest turn,
+# separately for every sample size since scores on different samples don't
+# compare.
+def pareto_fronts(results):
+    fronts = {}
+    for name, result in sorted(results.items(),
+                               key=lambda r: (r[1]['max_turn_ms'],
+                                              -r[1]['mean_score'])):
+        front = fronts.setdefault(result['scenarios'], [])
+        if not front or result['mean_score'] > front[-1]['mean_score']:
+            front.append(dict(result, name=name))
+    return fronts
+
+def main():
+    parser = argparse.ArgumentParser(
+        usage='./tuner.py [options] TEST_SET')
+    parser.add_argument('test_set', help='test set directory or corpus file')
+    parser.add_argument('--sweep', default='./param_sweep')
+    parser.add_argument('--latency-ms', type=float, default=100.0,
+                        help='ceiling on the slowest turn of a configuration')
+    parser.add_argument('--eta', type=int, default=3)
+    parser.add_argument('--min-scenarios', type=int, default=8)
+    parser.add_argument('--chunk-size', type=int, default=4)
+    parser.add_argument('--jobs', type=int, default=multiprocessing.cpu_count(),
+                        help='at most one per available core')
+    parser.add_argument('--seed', type=int, default=0)
+    parser.add_argument('--out', default='tuning.json')
+    args = parser.parse_args()
+
+    try:
+        scenarios_num, configs = list_configs(args.sweep, args.test_set)
+    except subprocess.CalledProcessError:
+        sys.exit('{} failed to list {}'.format(args.sweep, args.test_set))
+    if scenarios_num == 0:
+        sys.exit('No scenarios in {}'.format(args.test_set))
+    scenarios = list(range(scenarios_num))
+    random.Random(args.seed).shuffle(scenarios)
+
+    # The last evaluation of every configuration.
+    results = {}
+    survivors = list(range(len(configs)))
+    # Configurations cut by score, the ones cut in later rounds first.
+    dropped = []
+    sample_size = min(args.min_scenarios, scenarios_num)
+    with make_pool(args.jobs) as pool:
+        while True:
+            sample = scenarios[:sample_size]
+            evaluations = evaluate(pool, args, survivors, sample)
+            survivors = [config_id for config_id in survivors
+                         if fits_latency(args, config_id,
+                                         evaluations[config_id], sample)]
+            for config_id, evaluation in evaluations.items():
+                results[configs[config_id]] = evaluation.to_dict()
+            survivors.sort(key=lambda c: evaluations[c].mean_score(),
+                           reverse=True)
+            print('{} scenarios: {} configurations within {}ms'.format(
+                sample_size, len(survivors), args.latency_ms))
+            for config_id in survivors[:3]:
+                print('  {:8.2f} {}'.format(evaluations[config_id].mean_score(),
+                                            configs[config_id]))
+            if len(survivors) <= 1 or sample_size == scenarios_num:
+                break
+            kept_num = max(1, len(survivors) // args.eta)
+            dropped = survivors[kept_num:] + dropped
+            survivors = survivors[:kept_num]
+            sample_size = min(sample_size * args.eta, scenarios_num)
+        # The winner is reported on the whole test set. Its latency is checked
+        # again there, if it doesn't fit the next best configuration is tried.
+        # Only the survivors of a round on the whole test set have been
+        # checked there already.
+        checked = survivors if sample_size == scenarios_num else []
+        best = None
+        for config_id in survivors + dropped:
+            if config_id not in checked:
+                evaluation = evaluate(pool, args, [config_id],
+                                      scenarios)[config_id]
+                fits = fits_latency(args, config_id, evaluation, scenarios)
+                results[configs[config_id]] = evaluation.to_dict()
+                if not fits:
+                    print('{} exceeds {}ms on the whole test set'.format(
+                        configs[config_id], args.latency_ms))
+                    continue
+            best = config_id
+            break
+
+    report = {'test_set': args.test_set,
+              'latency_ms': args.latency_ms,
+              'best': (dict(results[configs[best]], name=configs[best])
+                       if best is not None else None),
+              'pareto_fronts': pareto_fronts(results),
+              'results': results}
+    with open(args.out, 'w') as f:
+        json.dump(report, f, indent=2)
+    if best is not None:
+        print('Best: {}'.format(configs[best]))
+    else:
+        print('No configuration fits into {}ms'.format(args.latency_ms))
+
+if __name__ == '__main__':
+    main()
@@ -36,8 +36,7 @@ void World::step() {
 
   // 2. If a MOVE command was given, Wolff moves towards his target.
   if (wolff.isMoving()) {
-    if (wolff.target_pos.x < 0 || wolff.target_pos.x >= 16000
-        || wolff.target_pos.y < 0 || wolff.target_pos.y >= 9000) {
+    if (!wolff.target_pos.IsInsideArena()) {
       score = 0;
       is_wolff_killed = true;
       return;
@@ -145,6 +144,31 @@ void World::CalculateBonus() {
   score += data_points.size() * std::max(0, initial_life_points_sum - 3 * shots_num) * 3;
 }
 
+uint64_t World::Hash() const {
+  // FNV-1a over 32-bit words rather than bytes, in input order.
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash](int value) {
+    hash ^= static_cast<uint32_t>(value);
+    hash *= 1099511628211ULL;
+  };
+  add(wolff.pos.x);
+  add(wolff.pos.y);
+  add(data_points.size());
+  for (const auto& dp : data_points) {
+    add(dp.id);
+    add(dp.pos.x);
+    add(dp.pos.y);
+  }
+  add(enemies.size());
+  for (const auto& enemy : enemies) {
+    add(enemy.id);
+    add(enemy.pos.x);
+    add(enemy.pos.y);
+    add(enemy.life_points);
+  }
+  return hash;
+}
+
 void World::Init() {
   initial_life_points_sum = 0;
   for (const auto& e : enemies) {
@@ -159,3 +183,29 @@ void World::Init() {
 std::ostream& operator<<(std::ostream& out, const Vector2D& v) {
   return out << "(" << v.x << " " << v.y << ")";
 }
+
+bool ReadWorld(std::istream& in, World& world) {
+  world = World();
+  int data_points_num;
+  if (!(in >> world.wolff.pos.x >> world.wolff.pos.y)) {
+    return false;
+  }
+  if (world.wolff.pos.x == kNewGameMarker) {
+    return true;
+  }
+  in >> data_points_num;
+  for (int i = 0; i < data_points_num; ++i) {
+    int id, x, y;
+    in >> id >> x >> y;
+    world.data_points.push_back(DataPoint(id, x, y));
+  }
+  int enemies_num;
+  in >> enemies_num;
+  for (int i = 0; i < enemies_num; ++i) {
+    int id, x, y, life_points;
+    in >> id >> x >> y >> life_points;
+    world.enemies.push_back(Enemy(id, x, y, life_points));
+  }
+  world.Init();
+  return static_cast<bool>(in);
+}
@@ -1,11 +1,18 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <list>
 #include <iostream>
 
 constexpr int kEnemyRange = 2000;
+constexpr int kWidth = 16000;
+constexpr int kHeight = 9000;
+// Sent by the simulator in place of Wolff's position when a persistent bot
+// process should forget the finished game and start a new one.
+constexpr int kNewGameMarker = -1;
 
 struct Enemy;
 struct DataPoint;
@@ -13,6 +20,11 @@ struct Wolff;
 struct World;
 struct Vector2D;
 std::ostream& operator<<(std::ostream& out, const Vector2D& v);
+// Reads a world in the format of the game input (which is also the format of
+// test files) and calls World::Init on it. Returns false if input has ended.
+// If kNewGameMarker is read in place of Wolff's position nothing else is read
+// and wolff.pos.x is left equal to kNewGameMarker.
+bool ReadWorld(std::istream& in, World& world);
 
 struct Vector2D {
   Vector2D() {}
@@ -36,6 +48,13 @@ struct Vector2D {
       y += floor(dy * speed / d);
     }
   }
+  bool IsInsideArena() const {
+    return x >= 0 && x < kWidth && y >= 0 && y < kHeight;
+  }
+  void ClampToArena() {
+    x = std::min(std::max(x, 0), kWidth - 1);
+    y = std::min(std::max(y, 0), kHeight - 1);
+  }
   int speed;
   int x, y;
 };
@@ -90,6 +109,9 @@ struct World {
   int FindNearestEnemy(const Vector2D& pos) const;
   bool IsGameOver() const;
   void CalculateBonus();
+  // Hash of everything the game input tells about the world: Wolff's
+  // position, data points and enemies.
+  uint64_t Hash() const;
   bool IsEnemyAlive(int id) const {
     for (const auto& enemy : enemies) {
       if (enemy.id == id) {